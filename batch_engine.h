@@ -0,0 +1,323 @@
+//-----------------------------------------------------------------------------
+// 배치(lockstep) 엔진 본체
+//
+// scheduler.c 가 레인 수별로 여러 번 include 하는 템플릿 (그래서 include guard 없음).
+// include 전에 정의할 것:
+//   BATCH_LANES  : 레인 수 = vlane 원소 수
+//   BATCH_SUFFIX : 이 파일이 만드는 타입/함수 이름 접미사 (예: _w8)
+//   BATCH_TARGET : 함수마다 붙일 속성 (예: __attribute__((target("avx2"))), 기본 ISA 면 빈 값)
+// 만들어지는 것: run_batch##BATCH_SUFFIX(jobs, n, pol, out)
+// 끝에서 위 세 매크로와 내부 이름 매크로를 #undef 하므로 다음 include 에서 다시 정의
+//
+// 동작 순서와 큐 순서 표현은 scheduler.c 의 "배치(lockstep) 시뮬레이션" 주석 참고
+
+#define vlane           BATCH_NAME(vlane)
+#define batch_lanes     BATCH_NAME(batch_lanes)
+#define batch_load      BATCH_NAME(batch_load)
+#define batch_store     BATCH_NAME(batch_store)
+#define batch_admit     BATCH_NAME(batch_admit)
+#define batch_io        BATCH_NAME(batch_io)
+#define batch_step      BATCH_NAME(batch_step)
+#define run_batch_lanes BATCH_NAME(run_batch)
+
+typedef int vlane __attribute__((vector_size(BATCH_LANES * sizeof(int))));
+
+typedef struct batch_lanes {
+    // 슬롯별 (슬롯 순서 = sort_by_arrival 후 job 큐 순서)
+    vlane pid[MAX_PROCESS_NUM];             // 빈 슬롯은 0
+    vlane arrival[MAX_PROCESS_NUM];
+    vlane CPU_burst[MAX_PROCESS_NUM];
+    vlane priority[MAX_PROCESS_NUM];
+    vlane CPU_remaining[MAX_PROCESS_NUM];
+    vlane io_count[MAX_PROCESS_NUM];
+    vlane io_request_times[MAX_IO_EVENTS][MAX_PROCESS_NUM];
+    vlane current_io[MAX_PROCESS_NUM];
+    vlane IO_burst[MAX_PROCESS_NUM];
+    vlane IO_remaining[MAX_PROCESS_NUM];
+    vlane ready_since[MAX_PROCESS_NUM];
+    vlane waiting_time[MAX_PROCESS_NUM];
+    vlane turnaround_time[MAX_PROCESS_NUM];
+    vlane state[MAX_PROCESS_NUM];
+    vlane rkey[MAX_PROCESS_NUM];
+    vlane wkey[MAX_PROCESS_NUM];
+
+    // 레인별
+    vlane clock;
+    vlane exe;                      // 실행 중 슬롯, 없으면 -1
+    vlane quantum;                  // RR: 현재 quantum 에서 실행한 tick 수
+    vlane rseq, wseq;
+    vlane live;                     // 워크로드 진행 중이면 -1
+    int   job[BATCH_LANES];         // 레인에 올라간 워크로드 번호
+} batch_lanes;
+
+// 레인 l 에 워크로드 jq 를 올림
+//   슬롯 순서는 sort_by_arrival 과 같음(arrival 오름차순, 같으면 큐 순서 = 안정 정렬).
+//   sort_by_arrival 을 부르지 않고 여기서 정렬하는 이유: 그 함수는 기본 ISA(SSE)로
+//   컴파일되어 있어 AVX 상태에서 호출하면 전환 비용으로 16 레인 경로가 약 20% 느려짐
+static BATCH_TARGET void batch_load(batch_lanes *b, int l, const queue *jq, int job) {
+    int ord[MAX_PROCESS_NUM];
+    for (int i = 0; i < jq->size; i++) {
+        int arr = jq->p[(jq->front + i) % MAX_QUEUE_SIZE].arrival;
+        int k   = i;
+        while (k > 0 && jq->p[(jq->front + ord[k - 1]) % MAX_QUEUE_SIZE].arrival > arr) {
+            ord[k] = ord[k - 1];
+            k--;
+        }
+        ord[k] = i;
+    }
+    for (int s = 0; s < MAX_PROCESS_NUM; s++) {
+        if (s >= jq->size) {
+            b->pid[s][l]   = 0;
+            b->state[s][l] = BS_DONE;
+            continue;
+        }
+        const process *pr = &jq->p[(jq->front + ord[s]) % MAX_QUEUE_SIZE];
+        b->pid[s][l]           = pr->pid;
+        b->arrival[s][l]       = pr->arrival;
+        b->CPU_burst[s][l]     = pr->CPU_burst;
+        b->priority[s][l]      = pr->priority;
+        b->CPU_remaining[s][l] = pr->CPU_remaining;
+        b->io_count[s][l]      = pr->io_count;
+        for (int k = 0; k < MAX_IO_EVENTS; k++) {
+            b->io_request_times[k][s][l] = k < pr->io_count ? pr->io_request_times[k] : 0;
+        }
+        b->current_io[s][l]      = 0;
+        b->IO_burst[s][l]        = pr->IO_burst;
+        b->IO_remaining[s][l]    = pr->IO_remaining;
+        b->ready_since[s][l]     = 0;
+        b->waiting_time[s][l]    = 0;
+        b->turnaround_time[s][l] = 0;
+        b->state[s][l]           = BS_JOB;
+        b->rkey[s][l]            = 0;
+        b->wkey[s][l]            = 0;
+    }
+    b->clock[l]   = 0;
+    b->exe[l]     = -1;
+    b->quantum[l] = 0;
+    b->rseq[l]    = 0;
+    b->wseq[l]    = 0;
+    b->live[l]    = -1;
+    b->job[l]     = job;
+}
+
+// 레인 l 의 결과를 out 에 기록 (run_scheduler 의 평균 계산과 같은 방식)
+static BATCH_TARGET void batch_store(const batch_lanes *b, int l, batch_result *out) {
+    double sw = 0, st = 0;
+    out->n = 0;
+    for (int s = 0; s < MAX_PROCESS_NUM; s++) {
+        if (b->pid[s][l] <= 0) continue;
+        int i = b->pid[s][l] - 1;
+        out->waiting_time[i]    = b->waiting_time[s][l];
+        out->turnaround_time[i] = b->turnaround_time[s][l];
+        sw += b->waiting_time[s][l];
+        st += b->turnaround_time[s][l];
+        out->n++;
+    }
+    out->avg_wait = sw / out->n;
+    out->avg_turn = st / out->n;
+}
+
+// 도착 프로세스 → ready (mask 레인만)
+static inline BATCH_TARGET void batch_admit(batch_lanes *b, const vlane *mask) {
+    BATCH_UNROLL
+    for (int s = 0; s < MAX_PROCESS_NUM; s++) {
+        vlane m = *mask & (b->state[s] == BS_JOB) & (b->arrival[s] <= b->clock);
+        b->state[s]       = VSEL(m, (vlane){ 0 } + BS_READY, b->state[s]);
+        b->rkey[s]        = VSEL(m, b->rseq, b->rkey[s]);
+        b->ready_since[s] = VSEL(m, b->clock, b->ready_since[s]);
+        b->rseq          -= m;
+    }
+}
+
+// io_execute 와 동일: waiting 전원 IO_remaining--, 0 이 된 프로세스는 wkey 순서대로 ready 로
+static inline BATCH_TARGET void batch_io(batch_lanes *b, const vlane *mask) {
+    vlane fin[MAX_PROCESS_NUM];
+    BATCH_UNROLL
+    for (int s = 0; s < MAX_PROCESS_NUM; s++) {
+        vlane m = *mask & (b->state[s] == BS_WAIT);
+        b->IO_remaining[s] += m;
+        fin[s] = m & (b->IO_remaining[s] <= 0);
+    }
+    vlane cnt = { 0 };
+    BATCH_UNROLL
+    for (int s = 0; s < MAX_PROCESS_NUM; s++) {
+        vlane rank = { 0 };
+        BATCH_UNROLL
+        for (int t = 0; t < MAX_PROCESS_NUM; t++) {
+            rank -= fin[t] & (b->wkey[t] < b->wkey[s]);
+        }
+        b->state[s]       = VSEL(fin[s], (vlane){ 0 } + BS_READY, b->state[s]);
+        b->rkey[s]        = VSEL(fin[s], b->rseq + rank, b->rkey[s]);
+        b->ready_since[s] = VSEL(fin[s], b->clock, b->ready_since[s]);
+        cnt              -= fin[s];
+    }
+    b->rseq += cnt;
+}
+
+static BATCH_TARGET void batch_step(batch_lanes *b, const batch_policy *pol) {
+    const vlane none = (vlane){ 0 } - 1;
+
+    // a) 도착 / I/O
+    vlane top = pol->rr ? b->live & (b->exe < 0) : b->live;
+    batch_admit(b, &top);
+    batch_io(b, &top);
+
+    // b) 선점형: 실행 중 프로세스 재대기
+    if (pol->preemptive) {
+        BATCH_UNROLL
+        for (int s = 0; s < MAX_PROCESS_NUM; s++) {
+            vlane m = b->live & (b->exe == s);
+            b->state[s]       = VSEL(m, (vlane){ 0 } + BS_READY, b->state[s]);
+            b->rkey[s]        = VSEL(m, b->rseq, b->rkey[s]);
+            b->ready_since[s] = VSEL(m, b->clock, b->ready_since[s]);
+            b->rseq          -= m;
+        }
+        b->exe = none;
+    }
+
+    // c) CPU 할당: front = ready 큐 front, best = 정책상 최선 (같은 값이면 front 에 가까운 쪽)
+    //    기준 값은 v / d (작을수록 우선). HRRN 은 응답 비율의 역수 s / (w + s), 나머지는 d = 1
+    vlane front = none, fkey = (vlane){ 0 } + 0x7fffffff;
+    vlane best  = none, bkey = fkey, bval = { 0 }, bden = { 0 };
+    BATCH_UNROLL
+    for (int s = 0; s < MAX_PROCESS_NUM; s++) {
+        vlane r   = b->state[s] == BS_READY;
+        vlane key = b->rkey[s];
+        vlane v   = pol->pick == BATCH_PICK_SJF  ? b->CPU_remaining[s]
+                  : pol->pick == BATCH_PICK_PRIO ? b->priority[s]
+                  : pol->pick == BATCH_PICK_HRRN ? b->CPU_remaining[s]
+                  : pol->pick == BATCH_PICK_AGED ? b->priority[s] * AGING_INTERVAL + b->ready_since[s]
+                  : (vlane){ 0 };
+        vlane d   = pol->pick == BATCH_PICK_HRRN
+                  ? b->clock - b->ready_since[s] + b->CPU_remaining[s]
+                  : (vlane){ 0 } + 1;
+        vlane lhs = pol->pick == BATCH_PICK_HRRN ? v * bden : v;
+        vlane rhs = pol->pick == BATCH_PICK_HRRN ? bval * d : bval;
+        vlane isf = r & (key < fkey);
+        vlane isb = r & ((best < 0) | (lhs < rhs) | ((lhs == rhs) & (key < bkey)));
+        front = VSEL(isf, (vlane){ 0 } + s, front);
+        fkey  = VSEL(isf, key, fkey);
+        best  = VSEL(isb, (vlane){ 0 } + s, best);
+        bval  = VSEL(isb, v, bval);
+        bden  = VSEL(isb, d, bden);
+        bkey  = VSEL(isb, key, bkey);
+    }
+    vlane need = b->live & (b->exe < 0);
+    vlane idle = need & (front < 0);
+    vlane sel  = need & (front >= 0);
+    vlane run  = b->live & ~idle;
+    b->clock  -= idle;
+    b->exe     = VSEL(sel, best, b->exe);
+    b->quantum = VSEL(sel, (vlane){ 0 }, b->quantum);
+    BATCH_UNROLL
+    for (int s = 0; s < MAX_PROCESS_NUM; s++) {
+        // best 와 front 교환 → front 가 best 의 rkey 를 물려받음
+        vlane mf = sel & (front == s) & (best != s);
+        b->rkey[s]  = VSEL(mf, bkey, b->rkey[s]);
+        b->waiting_time[s] = VSEL(sel & (best == s),
+                                  b->waiting_time[s] + b->clock - b->ready_since[s],
+                                  b->waiting_time[s]);
+        b->state[s] = VSEL(run & (b->exe == s), (vlane){ 0 } + BS_RUN, b->state[s]);
+    }
+
+    // d) 1 tick 실행: 실행 중 슬롯 값 모으기
+    vlane cpu = { 0 }, cur = { 0 }, cnt = { 0 }, req = { 0 };
+    BATCH_UNROLL
+    for (int s = 0; s < MAX_PROCESS_NUM; s++) {
+        vlane m = run & (b->exe == s);
+        cpu = VSEL(m, b->CPU_remaining[s], cpu);
+        cur = VSEL(m, b->current_io[s], cur);
+        cnt = VSEL(m, b->io_count[s], cnt);
+        BATCH_UNROLL
+        for (int k = 0; k < MAX_IO_EVENTS; k++) {
+            req = VSEL(m & (cur == k), b->io_request_times[k][s], req);
+        }
+    }
+    vlane ioreq = run & (cur < cnt) & (cpu == req);
+    vlane norm  = run & ~ioreq;
+    b->clock -= run;
+    BATCH_UNROLL
+    for (int s = 0; s < MAX_PROCESS_NUM; s++) {
+        vlane m  = run & (b->exe == s);
+        vlane mi = m & ioreq;
+        b->CPU_remaining[s] += m;
+        // I/O 시작 → waiting
+        b->IO_remaining[s] = VSEL(mi, b->IO_burst[s], b->IO_remaining[s]);
+        b->current_io[s]  -= mi;
+        b->state[s]        = VSEL(mi, (vlane){ 0 } + BS_WAIT, b->state[s]);
+        b->wkey[s]         = VSEL(mi, b->wseq, b->wkey[s]);
+        b->wseq           -= mi;
+    }
+    b->exe = VSEL(ioreq, none, b->exe);
+
+    // 일반 tick: I/O/도착 재처리 후 완료 또는 quantum 만료
+    batch_io(b, &norm);
+    batch_admit(b, &norm);
+    BATCH_UNROLL
+    for (int s = 0; s < MAX_PROCESS_NUM; s++) {
+        vlane m   = norm & (b->exe == s);
+        vlane fin = m & (b->CPU_remaining[s] == 0);
+        vlane exp = pol->rr ? m & ~fin & (b->quantum == MAX_TIME_QUANTUM - 1) : (vlane){ 0 };
+        vlane tat = b->clock - b->arrival[s];
+        b->turnaround_time[s] = VSEL(fin, tat, b->turnaround_time[s]);
+        b->state[s] = VSEL(fin, (vlane){ 0 } + BS_DONE, b->state[s]);
+        b->state[s]       = VSEL(exp, (vlane){ 0 } + BS_READY, b->state[s]);
+        b->rkey[s]        = VSEL(exp, b->rseq, b->rkey[s]);
+        b->ready_since[s] = VSEL(exp, b->clock, b->ready_since[s]);
+        b->rseq          -= exp;
+        b->quantum       -= m & ~fin;
+        b->exe            = VSEL(fin | exp, none, b->exe);
+    }
+}
+
+static BATCH_TARGET void run_batch_lanes(const queue *jobs, int n, const batch_policy *pol,
+                                        batch_result *out) {
+    batch_lanes b;                  // vlane 정렬을 위해 스택에 둠
+
+    // 빈 레인도 매 tick 계산에 참여하므로 전 필드를 0 으로 (live = 0, state = BS_DONE)
+    memset(&b, 0, sizeof b);
+    int next = 0, live = 0;
+    for (int l = 0; l < BATCH_LANES; l++) {
+        if (next < n) {
+            batch_load(&b, l, &jobs[next], next);
+            next++;
+            live++;
+        } else {
+            b.exe[l] = -1;
+        }
+    }
+
+    while (live) {
+        batch_step(&b, pol);
+
+        // 끝난 레인 기록 후 다음 워크로드로 채움
+        vlane busy = { 0 };
+        BATCH_UNROLL
+        for (int s = 0; s < MAX_PROCESS_NUM; s++) busy |= b.state[s] != BS_DONE;
+        for (int l = 0; l < BATCH_LANES; l++) {
+            if (!b.live[l] || busy[l]) continue;
+
+            batch_store(&b, l, &out[b.job[l]]);
+            if (next < n) {
+                batch_load(&b, l, &jobs[next], next);
+                next++;
+            } else {
+                b.live[l] = 0;
+                live--;
+            }
+        }
+    }
+}
+
+#undef vlane
+#undef batch_lanes
+#undef batch_load
+#undef batch_store
+#undef batch_admit
+#undef batch_io
+#undef batch_step
+#undef run_batch_lanes
+
+#undef BATCH_LANES
+#undef BATCH_SUFFIX
+#undef BATCH_TARGET